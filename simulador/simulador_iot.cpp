@@ -0,0 +1,306 @@
+// Simulador / generador de carga para sistema_iot
+// Emite el mismo protocolo de texto que sketch_oct30a.ino:
+//   T;T-001;25.6
+//   P;P-105;82
+// hacia un pseudo-terminal, una tubería (FIFO), un archivo o stdout.
+// Con -b emite en su lugar la trama binaria de ProtocoloBinario.h.
+//
+// Uso: simulador_iot [opciones]
+//   -o <ruta>   destino (archivo o FIFO); "-" = stdout; sin -o se crea un pseudo-terminal
+//   -t <n>      sensores de temperatura (default 1)
+//   -p <n>      sensores de presion (default 1)
+//   -r <n>      lineas por segundo, 0 = lo mas rapido posible (default 10)
+//   -n <n>      total de lineas a enviar, 0 = sin limite (default 0)
+//   -d <u|g|c>  distribucion: uniforme, gaussiana o caminata aleatoria (default c)
+//   -e <frac>   fraccion de tramas malformadas entre 0 y 1 (default 0)
+//   -m          agrega la marca de tiempo de envio en microsegundos como 4o campo;
+//               cada linea se escribe al formarla para que la marca no incluya la espera en el buffer
+//   -b          usa tramas binarias (sin marca de tiempo, no admite -m); las malformadas llevan CRC invalido
+//   -s <n>      semilla del generador aleatorio
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <csignal>
+#include <cerrno>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <unistd.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <time.h>
+
+#include "../src/ProtocoloBinario.h"
+
+using namespace std;
+
+const int MAX_SENSORES = 100000;
+
+// Configuración leída de la línea de comandos
+struct Config {
+    const char* salida;
+    int numTemp;
+    int numPres;
+    double tasa;
+    long long total;
+    char distribucion;
+    double fraccionErrores;
+    bool marcaTiempo;
+    bool binario;
+    unsigned semilla;
+
+    Config()
+        : salida(nullptr), numTemp(1), numPres(1), tasa(10), total(0),
+          distribucion('c'), fraccionErrores(0), marcaTiempo(false), binario(false),
+          semilla(static_cast<unsigned>(time(nullptr))) {}
+};
+
+// Buffer de salida: agrupa muchas líneas en una sola llamada a write()
+struct BufferSalida {
+    int fd;
+    char datos[16384];
+    size_t usado;
+
+    BufferSalida(int f) : fd(f), usado(0) {}
+
+    // Escribe lo acumulado; devuelve false si el lector cerró el destino
+    bool vaciar() {
+        size_t enviado = 0;
+        while (enviado < usado) {
+            ssize_t n = write(fd, datos + enviado, usado - enviado);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            enviado += static_cast<size_t>(n);
+        }
+        usado = 0;
+        return true;
+    }
+
+    bool agregar(const char* linea, size_t len) {
+        if (usado + len > sizeof(datos) && !vaciar()) {
+            return false;
+        }
+        std::memcpy(datos + usado, linea, len);
+        usado += len;
+        return true;
+    }
+};
+
+// Microsegundos de CLOCK_MONOTONIC, comparables con los de sistema_iot en el mismo equipo
+long long ahoraUs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<long long>(ts.tv_sec) * 1000000LL + ts.tv_nsec / 1000;
+}
+
+void mostrarUso() {
+    cerr << "Uso: simulador_iot [-o ruta|-] [-t n] [-p n] [-r lineas/s] [-n total]\n"
+         << "                   [-d u|g|c] [-e fraccion] [-m] [-b] [-s semilla]\n";
+}
+
+bool leerArgumentos(int argc, char* argv[], Config& cfg) {
+    int op;
+    while ((op = getopt(argc, argv, "o:t:p:r:n:d:e:mbs:h")) != -1) {
+        switch (op) {
+            case 'o': cfg.salida = optarg; break;
+            case 't': cfg.numTemp = atoi(optarg); break;
+            case 'p': cfg.numPres = atoi(optarg); break;
+            case 'r': cfg.tasa = atof(optarg); break;
+            case 'n': cfg.total = atoll(optarg); break;
+            case 'd': cfg.distribucion = optarg[0]; break;
+            case 'e': cfg.fraccionErrores = atof(optarg); break;
+            case 'm': cfg.marcaTiempo = true; break;
+            case 'b': cfg.binario = true; break;
+            case 's': cfg.semilla = static_cast<unsigned>(strtoul(optarg, nullptr, 10)); break;
+            default: return false;
+        }
+    }
+    if (cfg.numTemp < 0 || cfg.numPres < 0 || cfg.numTemp + cfg.numPres == 0 ||
+        cfg.numTemp + cfg.numPres > MAX_SENSORES) {
+        cerr << "El total de sensores debe estar entre 1 y " << MAX_SENSORES << ".\n";
+        return false;
+    }
+    if (cfg.binario && cfg.marcaTiempo) {
+        cerr << "La trama binaria no lleva marca de tiempo: -m no se puede usar con -b.\n";
+        return false;
+    }
+    if (cfg.binario && (cfg.numTemp > 0xFFFF || cfg.numPres > 0xFFFF)) {
+        cerr << "En modo binario el ID de cada tipo es de 16 bits (max 65535 sensores por tipo).\n";
+        return false;
+    }
+    if (cfg.distribucion != 'u' && cfg.distribucion != 'g' && cfg.distribucion != 'c') {
+        cerr << "Distribucion no valida.\n";
+        return false;
+    }
+    if (cfg.tasa < 0 || cfg.fraccionErrores < 0 || cfg.fraccionErrores > 1) {
+        cerr << "Tasa o fraccion de errores no valida.\n";
+        return false;
+    }
+    return true;
+}
+
+// Abre el destino; para el pseudo-terminal deja el esclavo en modo raw y muestra su ruta
+int abrirSalida(const Config& cfg) {
+    if (cfg.salida && std::strcmp(cfg.salida, "-") == 0) {
+        return STDOUT_FILENO;
+    }
+    if (cfg.salida) {
+        int fd = open(cfg.salida, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) perror("No se pudo abrir la salida");
+        return fd;
+    }
+
+    int maestro = posix_openpt(O_RDWR | O_NOCTTY);
+    if (maestro < 0 || grantpt(maestro) < 0 || unlockpt(maestro) < 0) {
+        perror("No se pudo crear el pseudo-terminal");
+        return -1;
+    }
+    struct termios opciones;
+    tcgetattr(maestro, &opciones);
+    cfmakeraw(&opciones); // sin eco: nadie lee lo que devolvería el esclavo
+    tcsetattr(maestro, TCSANOW, &opciones);
+
+    cerr << "Pseudo-terminal listo: " << ptsname(maestro) << "\n"
+         << "Ejecuta: sistema_iot " << ptsname(maestro) << "  (opcion 6)\n"
+         << "y presiona Enter aqui para empezar a enviar...\n";
+    cin.get();
+    return maestro;
+}
+
+// Genera una trama malformada de alguno de los tipos que el host debe tolerar.
+// El ID se toma del rango del tipo de la trama para que las que el host acepta
+// como bien formadas no agreguen sensores que la flota simulada no tiene.
+int tramaMalformada(char* linea, size_t max, mt19937& gen, const Config& cfg) {
+    uniform_int_distribution<int> tipo(0, 4);
+    uniform_int_distribution<int> sensorTemp(1, cfg.numTemp > 0 ? cfg.numTemp : 1);
+    uniform_int_distribution<int> sensorPres(1, cfg.numPres > 0 ? cfg.numPres : 1);
+    uniform_int_distribution<int> sensor(1, cfg.numTemp + cfg.numPres);
+    switch (tipo(gen)) {
+        case 0:  return snprintf(linea, max, "T;T-%03d\n", sensorTemp(gen));      // falta el valor
+        case 1:  return snprintf(linea, max, "X;X-%03d;12\n", sensor(gen));       // tipo desconocido
+        case 2:  return snprintf(linea, max, "T;T-%03d;abc\n", sensorTemp(gen));  // valor no numerico
+        case 3:                                                                   // fuera de rango
+            if (cfg.numPres > 0) return snprintf(linea, max, "P;P-%03d;-99999\n", sensorPres(gen));
+            return snprintf(linea, max, "T;T-%03d;-99999\n", sensorTemp(gen));
+        default: return snprintf(linea, max, ";;;\n");                           // campos vacios
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Config cfg;
+    if (!leerArgumentos(argc, argv, cfg)) {
+        mostrarUso();
+        return 1;
+    }
+    signal(SIGPIPE, SIG_IGN); // si el lector cierra, write() devuelve EPIPE
+
+    int fd = abrirSalida(cfg);
+    if (fd < 0) return 1;
+
+    int numSensores = cfg.numTemp + cfg.numPres;
+    double* estado = new double[numSensores]; // último valor de cada sensor (caminata)
+    for (int i = 0; i < numSensores; i++) {
+        estado[i] = (i < cfg.numTemp) ? 25.0 : 1013.0;
+    }
+
+    mt19937 gen(cfg.semilla);
+    uniform_real_distribution<double> uniforme(-1.0, 1.0);
+    normal_distribution<double> normal(0.0, 1.0);
+    uniform_real_distribution<double> probabilidad(0.0, 1.0);
+
+    BufferSalida buffer(fd);
+    char linea[96];
+    uint8_t trama[TRAMA_BYTES];
+    long long enviadas = 0;
+    long long malformadas = 0;
+    auto inicio = chrono::steady_clock::now();
+    auto ultimoReporte = inicio;
+    long long enviadasEnReporte = 0;
+
+    while (cfg.total == 0 || enviadas < cfg.total) {
+        int len;
+        bool malformada = cfg.fraccionErrores > 0 && probabilidad(gen) < cfg.fraccionErrores;
+        if (malformada && !cfg.binario) {
+            len = tramaMalformada(linea, sizeof(linea), gen, cfg);
+            malformadas++;
+        } else {
+            int i = static_cast<int>(enviadas % numSensores); // recorre los sensores en orden
+            bool esTemp = i < cfg.numTemp;
+            double base = esTemp ? 25.0 : 1013.0;
+            double escala = esTemp ? 0.3 : 1.0;
+            double v;
+            if (cfg.distribucion == 'u') {
+                v = base + uniforme(gen) * escala * 10;
+            } else if (cfg.distribucion == 'g') {
+                v = base + normal(gen) * escala * 3;
+            } else {
+                estado[i] += normal(gen) * escala;
+                v = estado[i];
+            }
+            if (cfg.binario) {
+                TramaBinaria t;
+                t.tipo = esTemp ? 'T' : 'P';
+                t.id = static_cast<uint16_t>(esTemp ? i + 1 : i - cfg.numTemp + 1);
+                t.valor = esTemp ? v : static_cast<int>(v);
+                codificarTrama(t, trama);
+                if (malformada) {
+                    trama[TRAMA_BYTES - 1] ^= 0xFF; // CRC inválido
+                    malformadas++;
+                }
+                std::memcpy(linea, trama, TRAMA_BYTES);
+                len = TRAMA_BYTES;
+            } else if (esTemp) {
+                len = snprintf(linea, sizeof(linea), "T;T-%03d;%.1f", i + 1, v);
+            } else {
+                len = snprintf(linea, sizeof(linea), "P;P-%03d;%d", i - cfg.numTemp + 1, static_cast<int>(v));
+            }
+            if (!cfg.binario) {
+                if (cfg.marcaTiempo) {
+                    len += snprintf(linea + len, sizeof(linea) - len, ";%lld", ahoraUs());
+                }
+                linea[len++] = '\n';
+            }
+        }
+
+        // Con -m la marca se toma al formar la línea: se vacía enseguida para que
+        // la latencia medida no incluya el tiempo que la línea pasa en el buffer
+        if (!buffer.agregar(linea, static_cast<size_t>(len)) ||
+            (cfg.marcaTiempo && !buffer.vaciar())) {
+            cerr << "El lector cerro la salida.\n";
+            break;
+        }
+        enviadas++;
+
+        if (cfg.tasa > 0) {
+            // Ritmo fijo: cada línea tiene su instante de envío programado
+            auto objetivo = inicio + chrono::duration_cast<chrono::steady_clock::duration>(
+                chrono::duration<double>(enviadas / cfg.tasa));
+            if (objetivo > chrono::steady_clock::now()) {
+                if (!buffer.vaciar()) break;
+                this_thread::sleep_until(objetivo);
+            }
+        }
+
+        auto ahora = chrono::steady_clock::now();
+        if (ahora - ultimoReporte >= chrono::seconds(1)) {
+            double seg = chrono::duration<double>(ahora - ultimoReporte).count();
+            cerr << "[Simulador] " << enviadas << " lineas enviadas, "
+                 << static_cast<long long>((enviadas - enviadasEnReporte) / seg) << " lineas/s\n";
+            ultimoReporte = ahora;
+            enviadasEnReporte = enviadas;
+        }
+    }
+    buffer.vaciar();
+
+    double total = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    cerr << "[Simulador] Total: " << enviadas << " lineas (" << malformadas << " malformadas) en "
+         << total << " s = " << static_cast<long long>(total > 0 ? enviadas / total : 0) << " lineas/s\n";
+
+    delete[] estado;
+    if (fd != STDOUT_FILENO) close(fd);
+    return 0;
+}
@@ -3,11 +3,43 @@
 // Formato: 
 //   T;T-001;25.6
 //   P;P-105;82
+// Con PROTOCOLO_BINARIO en 1 envía tramas binarias de 9 bytes
+// (ver src/ProtocoloBinario.h); el programa C++ detecta ambos formatos.
+
+#define PROTOCOLO_BINARIO 0
 
 unsigned long lastSend = 0;
 int presionFake = 80;
 float tempFake = 25.0;
 
+// CRC-8, polinomio 0x07 (igual que crc8() en ProtocoloBinario.h)
+uint8_t crc8(const uint8_t* datos, uint8_t n) {
+  uint8_t crc = 0;
+  for (uint8_t i = 0; i < n; i++) {
+    crc ^= datos[i];
+    for (uint8_t b = 0; b < 8; b++) {
+      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+// Trama: 0xA5, tipo, id (uint16 LE), valor*100 (int32 LE), CRC-8 de los bytes 1-7
+void enviarBinario(char tipo, uint16_t id, float valor) {
+  long v = lround(valor * 100.0);
+  uint8_t t[9];
+  t[0] = 0xA5;
+  t[1] = (uint8_t)tipo;
+  t[2] = id & 0xFF;
+  t[3] = id >> 8;
+  t[4] = v & 0xFF;
+  t[5] = (v >> 8) & 0xFF;
+  t[6] = (v >> 16) & 0xFF;
+  t[7] = (v >> 24) & 0xFF;
+  t[8] = crc8(t + 1, 7);
+  Serial.write(t, 9);
+}
+
 void setup() {
   Serial.begin(115200);
   // Espera a que se abra el puerto (en algunos Arduinos no es necesario, pero no estorba)
@@ -23,12 +55,20 @@ void loop() {
     static bool sendTemp = true;
     if (sendTemp) {
       tempFake += 0.3; // variar un poco
+#if PROTOCOLO_BINARIO
+      enviarBinario('T', 1, tempFake);
+#else
       Serial.print("T;T-001;");
       Serial.println(tempFake, 1); // 1 decimal
+#endif
     } else {
       presionFake += 1;
+#if PROTOCOLO_BINARIO
+      enviarBinario('P', 105, presionFake);
+#else
       Serial.print("P;P-105;");
       Serial.println(presionFake);
+#endif
     }
     sendTemp = !sendTemp;
   }
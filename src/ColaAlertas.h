@@ -0,0 +1,161 @@
+/**
+ * @file ColaAlertas.h
+ * @brief Cola sin bloqueos de eventos de alerta y su hilo notificador
+ * @author Barbie
+ * @date 2025
+ */
+
+#ifndef COLA_ALERTAS_H
+#define COLA_ALERTAS_H
+
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <chrono>
+
+/**
+ * @struct EventoAlerta
+ * @brief Cambio de estado de una regla de alerta
+ */
+struct EventoAlerta {
+    char sensor[50];   ///< Sensor que originó el evento
+    char regla[64];    ///< Descripción de la regla
+    double valor;      ///< Valor observado (lectura o promedio)
+    bool activa;       ///< true al activarse, false al normalizarse
+    long long marcaMs; ///< Momento de la lectura en milisegundos
+};
+
+/**
+ * @class ColaAlertas
+ * @brief Cola circular sin bloqueos de un productor y un consumidor
+ *
+ * El hilo de ingreso de lecturas es el único productor y el hilo
+ * notificador el único consumidor, por lo que basta con dos índices
+ * atómicos. Si la cola está llena el evento se descarta y se contabiliza,
+ * para no frenar nunca el ingreso de lecturas.
+ */
+class ColaAlertas {
+public:
+    static const unsigned CAPACIDAD = 1024; ///< Debe ser potencia de 2
+
+private:
+    EventoAlerta eventos[CAPACIDAD];        ///< Almacenamiento circular
+    std::atomic<unsigned> inicio;           ///< Siguiente posición a leer (consumidor)
+    std::atomic<unsigned> fin;              ///< Siguiente posición a escribir (productor)
+    std::atomic<unsigned long> descartados; ///< Eventos perdidos por cola llena
+
+public:
+    /**
+     * @brief Constructor - cola vacía
+     */
+    ColaAlertas() : inicio(0), fin(0), descartados(0) {}
+
+    ColaAlertas(const ColaAlertas&) = delete;
+    ColaAlertas& operator=(const ColaAlertas&) = delete;
+
+    /**
+     * @brief Encola un evento (solo desde el hilo productor)
+     * @param e Evento a encolar
+     * @return false si la cola estaba llena y el evento se descartó
+     */
+    bool encolar(const EventoAlerta& e) {
+        unsigned f = fin.load(std::memory_order_relaxed);
+        if (f - inicio.load(std::memory_order_acquire) == CAPACIDAD) {
+            descartados.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        eventos[f & (CAPACIDAD - 1)] = e;
+        fin.store(f + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Extrae un evento (solo desde el hilo consumidor)
+     * @param e Evento extraído
+     * @return false si la cola estaba vacía
+     */
+    bool desencolar(EventoAlerta& e) {
+        unsigned i = inicio.load(std::memory_order_relaxed);
+        if (i == fin.load(std::memory_order_acquire)) {
+            return false;
+        }
+        e = eventos[i & (CAPACIDAD - 1)];
+        inicio.store(i + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Obtiene cuántos eventos se perdieron por cola llena
+     * @return Número de eventos descartados
+     */
+    unsigned long getDescartados() const {
+        return descartados.load(std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @class NotificadorAlertas
+ * @brief Hilo que vacía la cola de alertas y las notifica por consola
+ *
+ * Se detiene y espera a su hilo al destruirse, después de vaciar
+ * los eventos pendientes.
+ */
+class NotificadorAlertas {
+private:
+    ColaAlertas& cola;           ///< Cola de la que consume
+    std::atomic<bool> corriendo; ///< Bandera de ejecución del hilo
+    std::thread hilo;            ///< Hilo notificador
+
+    /**
+     * @brief Imprime un evento de alerta
+     * @param e Evento a notificar
+     */
+    static void notificar(const EventoAlerta& e) {
+        std::cout << (e.activa ? "[ALERTA] " : "[ALERTA normalizada] ")
+                  << e.sensor << " " << e.regla << " (valor " << e.valor << ")\n";
+    }
+
+    /**
+     * @brief Ciclo del hilo: consume eventos hasta que se pide detenerse
+     */
+    void ejecutar() {
+        EventoAlerta e;
+        while (corriendo.load(std::memory_order_acquire)) {
+            if (cola.desencolar(e)) {
+                notificar(e);
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+        while (cola.desencolar(e)) {
+            notificar(e);
+        }
+    }
+
+public:
+    /**
+     * @brief Crea el notificador y arranca su hilo
+     * @param c Cola de alertas a consumir
+     */
+    NotificadorAlertas(ColaAlertas& c) : cola(c), corriendo(true) {
+        hilo = std::thread(&NotificadorAlertas::ejecutar, this);
+    }
+
+    NotificadorAlertas(const NotificadorAlertas&) = delete;
+    NotificadorAlertas& operator=(const NotificadorAlertas&) = delete;
+
+    /**
+     * @brief Detiene el hilo tras notificar lo pendiente
+     */
+    ~NotificadorAlertas() {
+        corriendo.store(false, std::memory_order_release);
+        if (hilo.joinable()) {
+            hilo.join();
+        }
+        if (cola.getDescartados() > 0) {
+            std::cout << "[Alertas] Eventos descartados por cola llena: " << cola.getDescartados() << "\n";
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,163 @@
+/**
+ * @file FiltroLecturas.h
+ * @brief Filtro incremental de lecturas atípicas aplicado al ingreso
+ * @author Barbie
+ * @date 2025
+ */
+
+#ifndef FILTRO_LECTURAS_H
+#define FILTRO_LECTURAS_H
+
+#include <cmath>
+
+/**
+ * @struct PoliticaFiltro
+ * @brief Parámetros que definen qué lecturas se consideran atípicas
+ *
+ * Cada tipo de sensor define su propia política. El rango [minimo, maximo]
+ * siempre se aplica (sin límites por defecto); maxCambio, maxZ y
+ * maxRechazosSeguidos quedan desactivados con un valor menor o igual a cero.
+ */
+struct PoliticaFiltro {
+    double minimo;           ///< Valor mínimo físicamente válido
+    double maximo;           ///< Valor máximo físicamente válido
+    double maxCambio;        ///< Máxima diferencia respecto a la última lectura aceptada
+    double maxZ;             ///< Máximo número de desviaciones respecto a la media móvil
+    double sigmaMinima;      ///< Desviación mínima usada en el z-score (evita dividir entre ~0)
+    double alfa;             ///< Peso de la lectura nueva en la media/varianza exponencial
+    int calentamiento;       ///< Lecturas aceptadas antes de aplicar el z-score
+    int maxRechazosSeguidos; ///< Rechazos consecutivos tras los cuales se acepta un nuevo nivel
+
+    /**
+     * @brief Política por defecto: solo descarta valores no finitos
+     */
+    PoliticaFiltro()
+        : minimo(-HUGE_VAL), maximo(HUGE_VAL), maxCambio(0), maxZ(0),
+          sigmaMinima(1), alfa(0.1), calentamiento(10), maxRechazosSeguidos(5) {}
+
+    /**
+     * @brief Política para sensores de temperatura (°C)
+     * @return Política con rango de -40 a 125 °C y saltos de hasta 10 °C
+     */
+    static PoliticaFiltro temperatura() {
+        PoliticaFiltro p;
+        p.minimo = -40;
+        p.maximo = 125;
+        p.maxCambio = 10;
+        p.maxZ = 4;
+        p.sigmaMinima = 0.5;
+        return p;
+    }
+
+    /**
+     * @brief Política para sensores de presión (hPa)
+     * @return Política con rango de 0 a 2000 hPa y saltos de hasta 50 hPa
+     */
+    static PoliticaFiltro presion() {
+        PoliticaFiltro p;
+        p.minimo = 0;
+        p.maximo = 2000;
+        p.maxCambio = 50;
+        p.maxZ = 4;
+        p.sigmaMinima = 2;
+        return p;
+    }
+};
+
+/**
+ * @class FiltroLecturas
+ * @brief Decide en O(1) si una lectura nueva se acepta o se descarta
+ *
+ * Mantiene una media y varianza móviles exponenciales de las lecturas
+ * aceptadas, de modo que cada lectura se evalúa una sola vez al llegar
+ * sin volver a recorrer el historial. Aplica, en orden: rango válido,
+ * límite de cambio respecto a la última lectura aceptada y z-score.
+ */
+class FiltroLecturas {
+private:
+    PoliticaFiltro politica; ///< Límites vigentes
+    double media;            ///< Media móvil exponencial
+    double varianza;         ///< Varianza móvil exponencial
+    double ultima;           ///< Última lectura aceptada
+    int aceptadas;           ///< Lecturas aceptadas desde el último reinicio
+    int rechazosSeguidos;    ///< Lecturas rechazadas de forma consecutiva
+
+    /**
+     * @brief Incorpora una lectura aceptada a la estadística móvil
+     * @param v Valor aceptado
+     */
+    void actualizar(double v) {
+        if (aceptadas == 0) {
+            media = v;
+            varianza = 0;
+        } else {
+            double d = v - media;
+            media += politica.alfa * d;
+            varianza = (1 - politica.alfa) * (varianza + politica.alfa * d * d);
+        }
+        ultima = v;
+        aceptadas++;
+        rechazosSeguidos = 0;
+    }
+
+public:
+    /**
+     * @brief Constructor
+     * @param p Política de filtrado a aplicar
+     */
+    FiltroLecturas(const PoliticaFiltro& p = PoliticaFiltro()) {
+        configurar(p);
+    }
+
+    /**
+     * @brief Cambia la política y reinicia la estadística
+     * @param p Nueva política de filtrado
+     */
+    void configurar(const PoliticaFiltro& p) {
+        politica = p;
+        media = 0;
+        varianza = 0;
+        ultima = 0;
+        aceptadas = 0;
+        rechazosSeguidos = 0;
+    }
+
+    /**
+     * @brief Evalúa una lectura nueva
+     * @param v Valor de la lectura
+     * @return true si la lectura es válida y debe almacenarse
+     *
+     * Los valores fuera de rango o no finitos se descartan siempre. Si el
+     * límite de cambio o el z-score rechazan demasiadas lecturas seguidas,
+     * se asume un cambio de nivel real y la estadística se reinicia.
+     */
+    bool aceptar(double v) {
+        if (!std::isfinite(v) || v < politica.minimo || v > politica.maximo) {
+            return false;
+        }
+        if (aceptadas > 0) {
+            bool atipica = false;
+            if (politica.maxCambio > 0 && std::fabs(v - ultima) > politica.maxCambio) {
+                atipica = true;
+            }
+            if (!atipica && politica.maxZ > 0 && aceptadas >= politica.calentamiento) {
+                double sigma = std::sqrt(varianza);
+                if (sigma < politica.sigmaMinima) sigma = politica.sigmaMinima;
+                if (std::fabs(v - media) / sigma > politica.maxZ) {
+                    atipica = true;
+                }
+            }
+            if (atipica) {
+                rechazosSeguidos++;
+                if (politica.maxRechazosSeguidos <= 0 || rechazosSeguidos < politica.maxRechazosSeguidos) {
+                    return false;
+                }
+                aceptadas = 0; // Cambio de nivel sostenido: se vuelve a calibrar
+            }
+        }
+        actualizar(v);
+        return true;
+    }
+};
+
+#endif
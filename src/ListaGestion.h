@@ -11,6 +11,7 @@
 #include "SensorBase.h"
 #include <iostream>
 #include <cstring>
+#include <cstdio>
 
 /**
  * @struct NodoGestion
@@ -27,6 +28,19 @@ struct NodoGestion {
     NodoGestion(SensorBase* s) : sensor(s), sig(nullptr) {}
 };
 
+/**
+ * @struct NodoIndice
+ * @brief Entrada del índice de sensores por (tipo, ID numérico)
+ */
+struct NodoIndice {
+    char tipo;          ///< Letra del tipo ('T', 'P')
+    unsigned id;        ///< ID numérico ("T-001" -> 1)
+    SensorBase* sensor; ///< Sensor indexado
+    NodoIndice* sig;    ///< Siguiente entrada de la misma cubeta
+
+    NodoIndice(char t, unsigned i, SensorBase* s) : tipo(t), id(i), sensor(s), sig(nullptr) {}
+};
+
 /**
  * @class ListaGestion
  * @brief Lista para administrar todos los sensores del sistema
@@ -36,13 +50,81 @@ struct NodoGestion {
  */
 class ListaGestion {
 private:
-    NodoGestion* cabeza; ///< Primer nodo de la lista
+    static const unsigned CUBETAS_INICIALES = 64; ///< Cubetas al crear el índice (potencia de 2)
+
+    NodoGestion* cabeza;        ///< Primer nodo de la lista
+    int tam;                    ///< Número de sensores registrados
+    ListaPendientes pendientes; ///< Sensores con lecturas nuevas sin procesar
+    NodoIndice** indice;        ///< Sensores con nombre "<tipo>-<ID>", por (tipo, ID)
+    unsigned cubetas;           ///< Cubetas del índice (potencia de 2)
+    unsigned indexados;         ///< Entradas del índice
+
+    unsigned cubeta(char tipo, unsigned id) const {
+        return (id * 31u + static_cast<unsigned char>(tipo)) & (cubetas - 1);
+    }
+
+    /**
+     * @brief Duplica las cubetas del índice y redistribuye las entradas
+     *
+     * Se llama cuando hay más entradas que cubetas, así que las cadenas
+     * se mantienen cortas aunque la flota llegue a decenas de miles de IDs.
+     */
+    void crecerIndice() {
+        unsigned nuevas = cubetas * 2;
+        NodoIndice** tabla = new NodoIndice*[nuevas];
+        for (unsigned i = 0; i < nuevas; i++) tabla[i] = nullptr;
+        unsigned anteriores = cubetas;
+        cubetas = nuevas;
+        for (unsigned i = 0; i < anteriores; i++) {
+            NodoIndice* e = indice[i];
+            while (e) {
+                NodoIndice* sig = e->sig;
+                unsigned c = cubeta(e->tipo, e->id);
+                e->sig = tabla[c];
+                tabla[c] = e;
+                e = sig;
+            }
+        }
+        delete[] indice;
+        indice = tabla;
+    }
+
+    /**
+     * @brief Extrae el (tipo, ID) de un nombre en forma canónica
+     * @return false si el nombre no es exactamente el que arma nombreDesdeTrama()
+     *
+     * Solo se indexa la forma canónica ("T-001", no "T-1") para que una
+     * trama binaria encuentre el mismo sensor que encontraría por nombre.
+     */
+    static bool idDesdeNombre(const char* nom, char& tipo, unsigned& id) {
+        if (!nom[0] || nom[1] != '-' || nom[2] == '\0') return false;
+        unsigned long v = 0;
+        for (const char* d = nom + 2; *d; d++) {
+            if (*d < '0' || *d > '9') return false;
+            v = v * 10 + static_cast<unsigned long>(*d - '0');
+            if (v > 0xFFFF) return false; // el ID de la trama es de 16 bits
+        }
+        char canonico[16];
+        std::snprintf(canonico, sizeof(canonico), "%c-%03lu", nom[0], v);
+        if (std::strcmp(canonico, nom) != 0) return false;
+        tipo = nom[0];
+        id = static_cast<unsigned>(v);
+        return true;
+    }
 
 public:
     /**
      * @brief Constructor por defecto
      */
-    ListaGestion() : cabeza(nullptr) {}
+    ListaGestion()
+        : cabeza(nullptr), tam(0), indice(new NodoIndice*[CUBETAS_INICIALES]),
+          cubetas(CUBETAS_INICIALES), indexados(0) {
+        for (unsigned i = 0; i < cubetas; i++) indice[i] = nullptr;
+    }
+
+    // Es dueña de los sensores y del índice: no se copia
+    ListaGestion(const ListaGestion&) = delete;
+    ListaGestion& operator=(const ListaGestion&) = delete;
 
     /**
      * @brief Destructor - libera todos los sensores
@@ -62,6 +144,14 @@ public:
             delete borr;
         }
         cabeza = nullptr;
+        for (unsigned i = 0; i < cubetas; i++) {
+            while (indice[i]) {
+                NodoIndice* borr = indice[i];
+                indice[i] = borr->sig;
+                delete borr;
+            }
+        }
+        delete[] indice;
     }
 
     /**
@@ -70,6 +160,19 @@ public:
      */
     void insertar(SensorBase* s) {
         NodoGestion* nuevo = new NodoGestion(s);
+        s->vincularPendientes(&pendientes);
+        tam++;
+        char tipo;
+        unsigned id;
+        if (idDesdeNombre(s->getNombre(), tipo, id) && !buscarPorId(tipo, id)) {
+            NodoIndice* entrada = new NodoIndice(tipo, id, s);
+            unsigned c = cubeta(tipo, id);
+            entrada->sig = indice[c];
+            indice[c] = entrada;
+            if (++indexados > cubetas) {
+                crecerIndice();
+            }
+        }
         if (!cabeza) {
             cabeza = nuevo;
             return;
@@ -95,6 +198,24 @@ public:
         return nullptr;
     }
 
+    /**
+     * @brief Busca un sensor por tipo e ID numérico (ej. 'T', 1 -> "T-001")
+     * @param tipo Letra del tipo de sensor
+     * @param id ID numérico
+     * @return Puntero al sensor encontrado o nullptr si no existe
+     *
+     * Usa el índice en lugar de comparar nombres, por eso es la búsqueda
+     * adecuada para las tramas binarias, que ya traen el ID como número.
+     */
+    SensorBase* buscarPorId(char tipo, unsigned id) const {
+        for (NodoIndice* e = indice[cubeta(tipo, id)]; e; e = e->sig) {
+            if (e->id == id && e->tipo == tipo) {
+                return e->sensor;
+            }
+        }
+        return nullptr;
+    }
+
     /**
      * @brief Ejecuta el procesamiento polimórfico de todos los sensores
      * 
@@ -106,18 +227,52 @@ public:
         NodoGestion* tmp = cabeza;
         while (tmp) {
             tmp->sensor->procesarLectura();
+            tmp->sensor->marcarProcesado();
             tmp = tmp->sig;
         }
     }
 
+    /**
+     * @brief Procesa solo los sensores que recibieron lecturas nuevas
+     * @return Número de sensores recalculados
+     *
+     * Solo recorre la cola de pendientes, así que el costo depende de
+     * cuántos sensores recibieron datos y no del tamaño de la flota.
+     * Los demás conservan su resultado en caché (ver imprimir()).
+     */
+    int procesarModificados() {
+        std::cout << "--- Ejecutando Procesamiento Polimórfico (solo sensores con datos nuevos) ---\n";
+        int procesados = 0;
+        SensorBase* s = pendientes.extraer();
+        while (s) {
+            // Pudo haberse procesado ya con procesarTodos() mientras esperaba
+            if (s->tieneDatosNuevos()) {
+                s->procesarLectura();
+                s->marcarProcesado();
+                procesados++;
+            }
+            s = pendientes.extraer();
+        }
+        if (tam > procesados) {
+            std::cout << "   " << (tam - procesados) << " sensor(es) sin datos nuevos conservan su último resultado.\n";
+        }
+        return procesados;
+    }
+
     /**
      * @brief Imprime información de todos los sensores
+     *
+     * Muestra el último promedio guardado de cada sensor sin recalcularlo.
      */
     void imprimir() const {
         std::cout << "[Lista de Sensores Registrados]\n";
         NodoGestion* tmp = cabeza;
         while (tmp) {
             tmp->sensor->imprimirInfo();
+            if (tmp->sensor->tieneResultado()) {
+                std::cout << "   Último promedio: " << tmp->sensor->getUltimoPromedio()
+                          << (tmp->sensor->tieneDatosNuevos() ? " (hay lecturas nuevas sin procesar)" : "") << "\n";
+            }
             tmp = tmp->sig;
         }
     }
@@ -9,6 +9,22 @@
 #define LISTA_SENSOR_H
 
 #include <iostream>
+#include <iterator>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @struct BloqueLS
+ * @brief Cabecera de un bloque de nodos reservado de una sola vez
+ *
+ * insertarLote() reserva la cabecera y todos los nodos del lote en una
+ * única asignación; el bloque se libera cuando sale su último nodo.
+ */
+struct BloqueLS {
+    int vivos; ///< Nodos del bloque que siguen en la lista
+};
 
 /**
  * @struct NodoLS
@@ -19,12 +35,20 @@ template <typename T>
 struct NodoLS {
     T dato;           ///< Valor almacenado en el nodo
     NodoLS<T>* sig;   ///< Puntero al siguiente nodo
+    BloqueLS* bloque; ///< Bloque que contiene al nodo (nullptr si se creó con new)
     
     /**
      * @brief Constructor del nodo
-     * @param d Dato a almacenar
+     * @param args Argumentos con los que se construye el dato en el nodo
+     *
+     * Acepta una copia, un valor movido o los argumentos del constructor
+     * de T, de modo que el dato se construye directamente en el nodo.
      */
-    NodoLS(const T& d) : dato(d), sig(nullptr) {}
+    template <typename... Args>
+    explicit NodoLS(Args&&... args) : dato(std::forward<Args>(args)...), sig(nullptr), bloque(nullptr) {}
+
+    NodoLS(const NodoLS&) = delete;
+    NodoLS& operator=(const NodoLS&) = delete;
 };
 
 /**
@@ -40,12 +64,105 @@ template <typename T>
 class ListaSensor {
 private:
     NodoLS<T>* cabeza; ///< Puntero al primer nodo de la lista
+    NodoLS<T>* cola;   ///< Puntero al último nodo (inserción en O(1))
+    int tam;           ///< Número de elementos almacenados
+
+    /**
+     * @brief Enlaza un nodo ya construido al final de la lista
+     * @param nuevo Nodo a enlazar
+     */
+    void enlazarFinal(NodoLS<T>* nuevo) {
+        if (!cabeza) {
+            cabeza = nuevo;
+        } else {
+            cola->sig = nuevo;
+        }
+        cola = nuevo;
+        tam++;
+    }
+
+    /**
+     * @brief Libera un nodo según cómo fue reservado
+     * @param nodo Nodo ya desenlazado de la lista
+     */
+    void liberarNodo(NodoLS<T>* nodo) {
+        BloqueLS* b = nodo->bloque;
+        if (!b) {
+            delete nodo;
+            return;
+        }
+        nodo->~NodoLS<T>();
+        if (--b->vivos == 0) {
+            ::operator delete(b);
+        }
+    }
 
 public:
+    /**
+     * @class Iterador
+     * @brief Iterador de avance (forward) sobre los datos de la lista
+     * @tparam U Tipo referenciado (T o const T)
+     */
+    template <typename U>
+    class Iterador {
+    private:
+        NodoLS<T>* actual; ///< Nodo al que apunta el iterador
+
+        friend class ListaSensor;
+        template <typename> friend class Iterador;
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef typename std::remove_const<U>::type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef U* pointer;
+        typedef U& reference;
+
+        /**
+         * @brief Construye un iterador sobre un nodo
+         * @param n Nodo inicial (nullptr equivale a end())
+         */
+        explicit Iterador(NodoLS<T>* n = nullptr) : actual(n) {}
+
+        /**
+         * @brief Conversión de iterador mutable a iterador constante
+         * @param other Iterador mutable
+         */
+        template <typename V, typename = typename std::enable_if<
+            std::is_const<U>::value && std::is_same<V, value_type>::value>::type>
+        Iterador(const Iterador<V>& other) : actual(other.actual) {}
+
+        /// @brief Acceso al dato del nodo actual
+        reference operator*() const { return actual->dato; }
+        /// @brief Acceso a miembros del dato del nodo actual
+        pointer operator->() const { return &actual->dato; }
+
+        /// @brief Avanza al siguiente nodo (prefijo)
+        Iterador& operator++() {
+            actual = actual->sig;
+            return *this;
+        }
+
+        /// @brief Avanza al siguiente nodo (postfijo)
+        Iterador operator++(int) {
+            Iterador copia(*this);
+            actual = actual->sig;
+            return copia;
+        }
+
+        /// @brief Compara si ambos iteradores apuntan al mismo nodo
+        bool operator==(const Iterador& other) const { return actual == other.actual; }
+        /// @brief Compara si los iteradores apuntan a nodos distintos
+        bool operator!=(const Iterador& other) const { return actual != other.actual; }
+    };
+
+    typedef Iterador<T> iterator;             ///< Iterador mutable
+    typedef Iterador<const T> const_iterator; ///< Iterador de solo lectura
+
     /**
      * @brief Constructor por defecto
      */
-    ListaSensor() : cabeza(nullptr) {}
+    ListaSensor() : cabeza(nullptr), cola(nullptr), tam(0) {}
 
     /**
      * @brief Destructor - libera toda la memoria
@@ -58,7 +175,7 @@ public:
      * @brief Constructor de copia
      * @param other Lista a copiar
      */
-    ListaSensor(const ListaSensor& other) : cabeza(nullptr) {
+    ListaSensor(const ListaSensor& other) : cabeza(nullptr), cola(nullptr), tam(0) {
         NodoLS<T>* aux = other.cabeza;
         while (aux) {
             insertarFinal(aux->dato);
@@ -66,6 +183,17 @@ public:
         }
     }
 
+    /**
+     * @brief Constructor de movimiento
+     * @param other Lista cuyos nodos se transfieren (queda vacía)
+     */
+    ListaSensor(ListaSensor&& other) noexcept
+        : cabeza(other.cabeza), cola(other.cola), tam(other.tam) {
+        other.cabeza = nullptr;
+        other.cola = nullptr;
+        other.tam = 0;
+    }
+
     /**
      * @brief Operador de asignación
      * @param other Lista a asignar
@@ -83,21 +211,108 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Operador de asignación por movimiento
+     * @param other Lista cuyos nodos se transfieren (queda vacía)
+     * @return Referencia a esta lista
+     */
+    ListaSensor& operator=(ListaSensor&& other) noexcept {
+        if (this != &other) {
+            limpiar();
+            cabeza = other.cabeza;
+            cola = other.cola;
+            tam = other.tam;
+            other.cabeza = nullptr;
+            other.cola = nullptr;
+            other.tam = 0;
+        }
+        return *this;
+    }
+
     /**
      * @brief Inserta un valor al final de la lista
      * @param valor Valor a insertar
      */
     void insertarFinal(const T& valor) {
-        NodoLS<T>* nuevo = new NodoLS<T>(valor);
+        enlazarFinal(new NodoLS<T>(valor));
+    }
+
+    /**
+     * @brief Inserta un valor al final de la lista moviéndolo
+     * @param valor Valor a mover dentro del nuevo nodo
+     */
+    void insertarFinal(T&& valor) {
+        enlazarFinal(new NodoLS<T>(std::move(valor)));
+    }
+
+    /**
+     * @brief Construye un valor directamente al final de la lista
+     * @param args Argumentos para el constructor de T
+     * @return Referencia al dato recién construido
+     */
+    template <typename... Args>
+    T& emplazarFinal(Args&&... args) {
+        NodoLS<T>* nuevo = new NodoLS<T>(std::forward<Args>(args)...);
+        enlazarFinal(nuevo);
+        return nuevo->dato;
+    }
+
+    /**
+     * @brief Inserta un lote de valores al final de la lista
+     * @param valores Arreglo con los valores a insertar
+     * @param n Cantidad de valores en el arreglo
+     *
+     * Reserva todos los nodos del lote en un solo bloque contiguo, los
+     * encadena y enlaza la cadena a la lista una sola vez, actualizando
+     * el tamaño en un solo paso.
+     */
+    void insertarLote(const T* valores, int n) {
+        if (n <= 0) return;
+        static_assert(alignof(NodoLS<T>) <= alignof(std::max_align_t),
+                      "NodoLS<T> requiere una alineación no soportada por el bloque");
+        const size_t alin = alignof(NodoLS<T>);
+        const size_t desp = (sizeof(BloqueLS) + alin - 1) / alin * alin;
+        char* memoria = static_cast<char*>(::operator new(desp + n * sizeof(NodoLS<T>)));
+        BloqueLS* bloque = new (memoria) BloqueLS;
+        bloque->vivos = n;
+        NodoLS<T>* nodos = reinterpret_cast<NodoLS<T>*>(memoria + desp);
+        for (int i = 0; i < n; i++) {
+            new (&nodos[i]) NodoLS<T>(valores[i]);
+            nodos[i].bloque = bloque;
+            if (i > 0) nodos[i-1].sig = &nodos[i];
+        }
+        NodoLS<T>* primero = &nodos[0];
+        NodoLS<T>* ultimo = &nodos[n-1];
         if (!cabeza) {
-            cabeza = nuevo;
-            return;
+            cabeza = primero;
+        } else {
+            cola->sig = primero;
         }
-        NodoLS<T>* tmp = cabeza;
-        while (tmp->sig) tmp = tmp->sig;
-        tmp->sig = nuevo;
+        cola = ultimo;
+        tam += n;
     }
 
+    /**
+     * @brief Iterador al primer elemento
+     * @return Iterador a la cabeza de la lista
+     */
+    iterator begin() { return iterator(cabeza); }
+
+    /**
+     * @brief Iterador posterior al último elemento
+     * @return Iterador nulo que marca el fin del recorrido
+     */
+    iterator end() { return iterator(); }
+
+    /// @copydoc begin()
+    const_iterator begin() const { return const_iterator(cabeza); }
+    /// @copydoc end()
+    const_iterator end() const { return const_iterator(); }
+    /// @copydoc begin()
+    const_iterator cbegin() const { return const_iterator(cabeza); }
+    /// @copydoc end()
+    const_iterator cend() const { return const_iterator(); }
+
     /**
      * @brief Verifica si la lista está vacía
      * @return true si está vacía, false en caso contrario
@@ -111,13 +326,7 @@ public:
      * @return Número de elementos
      */
     int contar() const {
-        int c = 0;
-        NodoLS<T>* tmp = cabeza;
-        while (tmp) {
-            c++;
-            tmp = tmp->sig;
-        }
-        return c;
+        return tam;
     }
 
     /**
@@ -164,11 +373,14 @@ public:
 
         if (antMenor == nullptr) {
             cabeza = cabeza->sig;
-            delete menor;
         } else {
             antMenor->sig = menor->sig;
-            delete menor;
         }
+        if (menor == cola) {
+            cola = antMenor;
+        }
+        liberarNodo(menor);
+        tam--;
     }
 
     /**
@@ -179,9 +391,11 @@ public:
         while (tmp) {
             NodoLS<T>* borr = tmp;
             tmp = tmp->sig;
-            delete borr;
+            liberarNodo(borr);
         }
         cabeza = nullptr;
+        cola = nullptr;
+        tam = 0;
     }
 
     /**
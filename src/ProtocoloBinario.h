@@ -0,0 +1,109 @@
+/**
+ * @file ProtocoloBinario.h
+ * @brief Trama binaria compacta alternativa a las líneas de texto
+ * @author Barbie
+ * @date 2025
+ *
+ * Formato de la trama (9 bytes, enteros en little-endian):
+ *
+ * | Byte | Campo                                     |
+ * |------|-------------------------------------------|
+ * | 0    | Sincronía (0xA5)                          |
+ * | 1    | Tipo de sensor ('T' o 'P')                |
+ * | 2-3  | ID numérico (uint16, "T-001" -> 1)        |
+ * | 4-7  | Valor en centésimas (int32, 25.6 -> 2560) |
+ * | 8    | CRC-8 (polinomio 0x07) de los bytes 1-7   |
+ *
+ * El byte de sincronía nunca aparece en las líneas de texto (ASCII),
+ * por lo que el host puede aceptar ambos formatos en el mismo puerto.
+ */
+
+#ifndef PROTOCOLO_BINARIO_H
+#define PROTOCOLO_BINARIO_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cmath>
+
+const uint8_t TRAMA_SINCRONIA = 0xA5; ///< Primer byte de toda trama binaria
+const int TRAMA_BYTES = 9;            ///< Tamaño fijo de la trama
+const double TRAMA_ESCALA = 100.0;    ///< Factor del valor en punto fijo
+
+/**
+ * @struct TramaBinaria
+ * @brief Contenido decodificado de una trama binaria
+ */
+struct TramaBinaria {
+    char tipo;    ///< 'T' o 'P'
+    uint16_t id;  ///< ID numérico del sensor
+    double valor; ///< Valor de la lectura
+};
+
+/**
+ * @brief Calcula el CRC-8 (polinomio 0x07, valor inicial 0)
+ * @param datos Bytes a procesar
+ * @param n Cantidad de bytes
+ * @return CRC de los datos
+ */
+inline uint8_t crc8(const uint8_t* datos, size_t n) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < n; i++) {
+        crc ^= datos[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x07) : static_cast<uint8_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief Codifica una lectura en una trama binaria
+ * @param t Lectura a codificar
+ * @param buf Buffer de al menos TRAMA_BYTES bytes
+ */
+inline void codificarTrama(const TramaBinaria& t, uint8_t* buf) {
+    int32_t v = static_cast<int32_t>(std::lround(t.valor * TRAMA_ESCALA));
+    uint32_t u = static_cast<uint32_t>(v);
+    buf[0] = TRAMA_SINCRONIA;
+    buf[1] = static_cast<uint8_t>(t.tipo);
+    buf[2] = static_cast<uint8_t>(t.id & 0xFF);
+    buf[3] = static_cast<uint8_t>(t.id >> 8);
+    buf[4] = static_cast<uint8_t>(u & 0xFF);
+    buf[5] = static_cast<uint8_t>((u >> 8) & 0xFF);
+    buf[6] = static_cast<uint8_t>((u >> 16) & 0xFF);
+    buf[7] = static_cast<uint8_t>(u >> 24);
+    buf[8] = crc8(buf + 1, TRAMA_BYTES - 2);
+}
+
+/**
+ * @brief Decodifica y valida una trama binaria
+ * @param buf Buffer con TRAMA_BYTES bytes
+ * @param t Lectura decodificada
+ * @return false si la sincronía o el CRC no coinciden
+ */
+inline bool decodificarTrama(const uint8_t* buf, TramaBinaria& t) {
+    if (buf[0] != TRAMA_SINCRONIA || crc8(buf + 1, TRAMA_BYTES - 2) != buf[8]) {
+        return false;
+    }
+    uint32_t u = static_cast<uint32_t>(buf[4]) |
+                 (static_cast<uint32_t>(buf[5]) << 8) |
+                 (static_cast<uint32_t>(buf[6]) << 16) |
+                 (static_cast<uint32_t>(buf[7]) << 24);
+    t.tipo = static_cast<char>(buf[1]);
+    t.id = static_cast<uint16_t>(buf[2] | (buf[3] << 8));
+    t.valor = static_cast<int32_t>(u) / TRAMA_ESCALA;
+    return true;
+}
+
+/**
+ * @brief Forma el nombre textual del sensor a partir de su ID numérico
+ * @param t Trama decodificada
+ * @param nombre Buffer de salida (ej. "T-001")
+ * @param max Tamaño del buffer
+ */
+inline void nombreDesdeTrama(const TramaBinaria& t, char* nombre, size_t max) {
+    std::snprintf(nombre, max, "%c-%03u", t.tipo, static_cast<unsigned>(t.id));
+}
+
+#endif
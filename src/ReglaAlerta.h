@@ -0,0 +1,152 @@
+/**
+ * @file ReglaAlerta.h
+ * @brief Reglas de alerta por umbral evaluadas de forma incremental
+ * @author Barbie
+ * @date 2025
+ */
+
+#ifndef REGLA_ALERTA_H
+#define REGLA_ALERTA_H
+
+#include <cstdio>
+
+/**
+ * @class ReglaAlerta
+ * @brief Regla de umbral sobre el valor instantáneo o el promedio en una ventana
+ *
+ * La regla se "compila" al construirse: el tipo, la comparación y el
+ * ancho de cada cubeta de tiempo quedan fijos, de modo que evaluar una
+ * lectura cuesta O(1) (a lo sumo NUM_CUBETAS pasos al avanzar el tiempo)
+ * sin importar cuántas lecturas tenga el historial del sensor.
+ *
+ * La regla dispara por flanco: solo informa cuando la condición pasa de
+ * falsa a verdadera (activación) o de verdadera a falsa (normalización).
+ */
+class ReglaAlerta {
+public:
+    /**
+     * @brief Valor sobre el que se aplica el umbral
+     */
+    enum Tipo {
+        INSTANTANEA,     ///< Cada lectura individual
+        PROMEDIO_VENTANA ///< Promedio de las lecturas dentro de la ventana de tiempo
+    };
+
+    static const int NUM_CUBETAS = 60; ///< Resolución de la ventana deslizante
+
+private:
+    Tipo tipo;             ///< Tipo de regla
+    bool mayorQue;         ///< true: alerta si valor > umbral; false: si valor < umbral
+    double umbral;         ///< Umbral de la regla
+    long long anchoCubeta; ///< Duración de cada cubeta en milisegundos
+    char descripcion[64];  ///< Texto legible de la regla (ej. "promedio 60 s > 40")
+    bool activa;           ///< Estado actual de la condición
+
+    double suma[NUM_CUBETAS]; ///< Suma de lecturas por cubeta
+    int cuenta[NUM_CUBETAS];  ///< Número de lecturas por cubeta
+    long long ultimaCubeta;   ///< Índice absoluto de la cubeta más reciente
+    double sumaVentana;       ///< Suma de todas las cubetas vigentes
+    int cuentaVentana;        ///< Número de lecturas vigentes
+
+    /**
+     * @brief Desliza la ventana hasta la cubeta indicada
+     * @param cubeta Índice absoluto de la cubeta actual
+     *
+     * Vacía las cubetas que quedaron fuera de la ventana; como mucho
+     * recorre NUM_CUBETAS posiciones aunque haya pasado mucho tiempo.
+     */
+    void avanzarHasta(long long cubeta) {
+        if (ultimaCubeta < 0 || cubeta - ultimaCubeta >= NUM_CUBETAS) {
+            for (int i = 0; i < NUM_CUBETAS; i++) {
+                suma[i] = 0;
+                cuenta[i] = 0;
+            }
+            sumaVentana = 0;
+            cuentaVentana = 0;
+        } else {
+            for (long long c = ultimaCubeta + 1; c <= cubeta; c++) {
+                int idx = static_cast<int>(c % NUM_CUBETAS);
+                sumaVentana -= suma[idx];
+                cuentaVentana -= cuenta[idx];
+                suma[idx] = 0;
+                cuenta[idx] = 0;
+            }
+            if (cuentaVentana == 0) sumaVentana = 0; // Evita arrastrar error de redondeo
+        }
+        if (cubeta > ultimaCubeta) {
+            ultimaCubeta = cubeta;
+        }
+    }
+
+public:
+    /**
+     * @brief Construye y compila una regla
+     * @param t Tipo de regla
+     * @param mayor true para alertar por encima del umbral, false por debajo
+     * @param u Umbral
+     * @param ventanaMs Duración de la ventana en milisegundos (solo PROMEDIO_VENTANA)
+     */
+    ReglaAlerta(Tipo t, bool mayor, double u, long long ventanaMs = 60000)
+        : tipo(t), mayorQue(mayor), umbral(u), activa(false),
+          ultimaCubeta(-1), sumaVentana(0), cuentaVentana(0) {
+        anchoCubeta = ventanaMs / NUM_CUBETAS;
+        if (anchoCubeta < 1) anchoCubeta = 1;
+        for (int i = 0; i < NUM_CUBETAS; i++) {
+            suma[i] = 0;
+            cuenta[i] = 0;
+        }
+        if (tipo == INSTANTANEA) {
+            std::snprintf(descripcion, sizeof(descripcion), "valor %c %g",
+                          mayorQue ? '>' : '<', umbral);
+        } else {
+            std::snprintf(descripcion, sizeof(descripcion), "promedio %g s %c %g",
+                          ventanaMs / 1000.0, mayorQue ? '>' : '<', umbral);
+        }
+    }
+
+    /**
+     * @brief Evalúa la regla con una lectura nueva
+     * @param valor Valor de la lectura
+     * @param ahoraMs Marca de tiempo de la lectura en milisegundos
+     * @param observado Valor comparado contra el umbral (lectura o promedio)
+     * @return true si la condición cambió de estado con esta lectura
+     */
+    bool evaluar(double valor, long long ahoraMs, double& observado) {
+        if (tipo == INSTANTANEA) {
+            observado = valor;
+        } else {
+            long long cubeta = ahoraMs / anchoCubeta;
+            avanzarHasta(cubeta);
+            int idx = static_cast<int>(ultimaCubeta % NUM_CUBETAS);
+            suma[idx] += valor;
+            cuenta[idx]++;
+            sumaVentana += valor;
+            cuentaVentana++;
+            observado = sumaVentana / cuentaVentana;
+        }
+        bool cumple = mayorQue ? observado > umbral : observado < umbral;
+        if (cumple == activa) {
+            return false;
+        }
+        activa = cumple;
+        return true;
+    }
+
+    /**
+     * @brief Indica si la condición de la regla está activa
+     * @return true si la última evaluación cumplió la condición
+     */
+    bool estaActiva() const {
+        return activa;
+    }
+
+    /**
+     * @brief Obtiene la descripción legible de la regla
+     * @return Texto de la regla
+     */
+    const char* getDescripcion() const {
+        return descripcion;
+    }
+};
+
+#endif
@@ -10,6 +10,46 @@
 
 #include <iostream>
 #include <cstring>
+#include <cstdlib>
+#include <chrono>
+#include "FiltroLecturas.h"
+#include "ListaSensor.h"
+#include "ReglaAlerta.h"
+#include "ColaAlertas.h"
+
+class SensorBase;
+
+/**
+ * @class ListaPendientes
+ * @brief Cola intrusiva de sensores con lecturas nuevas sin procesar
+ *
+ * Un sensor entra en la cola la primera vez que recibe lecturas después
+ * de haber salido de ella, de modo que el procesamiento perezoso solo
+ * recorre los sensores con datos nuevos y no la flota completa.
+ */
+class ListaPendientes {
+private:
+    SensorBase* cabeza; ///< Primer sensor pendiente
+    SensorBase* cola;   ///< Último sensor pendiente
+
+public:
+    /**
+     * @brief Constructor - cola vacía
+     */
+    ListaPendientes() : cabeza(nullptr), cola(nullptr) {}
+
+    /**
+     * @brief Agrega un sensor al final (solo si no está ya en la cola)
+     * @param s Sensor con lecturas nuevas
+     */
+    void agregar(SensorBase* s);
+
+    /**
+     * @brief Extrae el primer sensor pendiente
+     * @return Sensor extraído o nullptr si la cola está vacía
+     */
+    SensorBase* extraer();
+};
 
 /**
  * @class SensorBase
@@ -22,13 +62,67 @@
 class SensorBase {
 protected:
     char nombre[50]; ///< Identificador único del sensor (ej. "T-001", "P-105")
+    unsigned long generacion;          ///< Se incrementa con cada ingreso de lecturas
+    unsigned long generacionProcesada; ///< Generación vista en el último procesamiento
+    FiltroLecturas filtro;             ///< Filtro de lecturas atípicas aplicado al ingreso
+    ListaSensor<ReglaAlerta> reglas;   ///< Reglas de alerta evaluadas en cada lectura
+    ColaAlertas* colaAlertas;          ///< Cola donde se publican los eventos (puede ser nullptr)
+    double ultimoPromedio;             ///< Resultado del último procesamiento (caché)
+    bool conResultado;                 ///< true si ya hubo al menos un procesamiento con datos
+    ListaPendientes* pendientes;       ///< Cola de pendientes del gestor (puede ser nullptr)
+    SensorBase* sigPendiente;          ///< Siguiente sensor en la cola de pendientes
+    bool enPendientes;                 ///< true mientras el sensor está en la cola de pendientes
+
+    friend class ListaPendientes;
+
+    /**
+     * @brief Marca que el sensor recibió lecturas nuevas
+     *
+     * Cada sensor debe llamarlo al insertar lecturas en su historial.
+     */
+    void marcarModificado() {
+        generacion++;
+        if (pendientes && !enPendientes) {
+            pendientes->agregar(this);
+        }
+    }
+
+    /**
+     * @brief Evalúa las reglas de alerta con una lectura aceptada
+     * @param valor Valor de la lectura
+     *
+     * Cada sensor debe llamarlo por cada lectura que inserta. El costo
+     * depende solo del número de reglas, no del tamaño del historial.
+     */
+    void evaluarReglas(double valor) {
+        if (reglas.estaVacia()) return;
+        long long ahoraMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        for (ReglaAlerta& r : reglas) {
+            double observado;
+            if (r.evaluar(valor, ahoraMs, observado) && colaAlertas) {
+                EventoAlerta e;
+                std::strncpy(e.sensor, nombre, sizeof(e.sensor));
+                e.sensor[sizeof(e.sensor)-1] = '\0';
+                std::strncpy(e.regla, r.getDescripcion(), sizeof(e.regla));
+                e.regla[sizeof(e.regla)-1] = '\0';
+                e.valor = observado;
+                e.activa = r.estaActiva();
+                e.marcaMs = ahoraMs;
+                colaAlertas->encolar(e);
+            }
+        }
+    }
 
 public:
     /**
      * @brief Constructor de la clase base
      * @param nom Nombre identificador del sensor
      */
-    SensorBase(const char* nom = "SIN-NOMBRE") {
+    SensorBase(const char* nom = "SIN-NOMBRE")
+        : generacion(0), generacionProcesada(0), colaAlertas(nullptr),
+          ultimoPromedio(0), conResultado(false),
+          pendientes(nullptr), sigPendiente(nullptr), enPendientes(false) {
         std::strncpy(nombre, nom, sizeof(nombre));
         nombre[sizeof(nombre)-1] = '\0';
     }
@@ -48,6 +142,66 @@ public:
         return nombre;
     }
 
+    /**
+     * @brief Cambia la política de filtrado de lecturas atípicas
+     * @param p Nueva política (reinicia la estadística del filtro)
+     */
+    void configurarFiltro(const PoliticaFiltro& p) {
+        filtro.configurar(p);
+    }
+
+    /**
+     * @brief Agrega una regla de alerta al sensor
+     * @param r Regla ya compilada
+     * @param cola Cola donde se publican los eventos de este sensor
+     */
+    void agregarRegla(const ReglaAlerta& r, ColaAlertas* cola) {
+        reglas.insertarFinal(r);
+        colaAlertas = cola;
+    }
+
+    /**
+     * @brief Asocia el sensor a la cola de pendientes de su gestor
+     * @param lp Cola donde se registrará al recibir lecturas nuevas
+     */
+    void vincularPendientes(ListaPendientes* lp) {
+        pendientes = lp;
+        if (pendientes && tieneDatosNuevos() && !enPendientes) {
+            pendientes->agregar(this);
+        }
+    }
+
+    /**
+     * @brief Indica si el sensor tiene un resultado calculado
+     * @return true si ya se procesó al menos una vez con lecturas
+     */
+    bool tieneResultado() const {
+        return conResultado;
+    }
+
+    /**
+     * @brief Obtiene el promedio del último procesamiento sin recalcularlo
+     * @return Promedio guardado (0 si aún no hay resultado)
+     */
+    double getUltimoPromedio() const {
+        return ultimoPromedio;
+    }
+
+    /**
+     * @brief Indica si hay lecturas nuevas desde el último procesamiento
+     * @return true si el resultado guardado ya no está al día
+     */
+    bool tieneDatosNuevos() const {
+        return generacion != generacionProcesada;
+    }
+
+    /**
+     * @brief Registra que el resultado actual corresponde a los datos vigentes
+     */
+    void marcarProcesado() {
+        generacionProcesada = generacion;
+    }
+
     /**
      * @brief Agrega una lectura al sensor desde texto
      * @param valorTxt Valor de la lectura en formato texto
@@ -57,6 +211,37 @@ public:
      */
     virtual void agregarLecturaDesdeTexto(const char* valorTxt) = 0;
 
+    /**
+     * @brief Agrega un lote de lecturas ya convertidas a número
+     * @param valores Arreglo de valores de la lectura
+     * @param n Cantidad de valores en el arreglo
+     *
+     * Método virtual puro que cada sensor implementa para insertar
+     * todas las lecturas del lote en una sola operación sobre su historial.
+     */
+    virtual void agregarLote(const double* valores, int n) = 0;
+
+    /**
+     * @brief Agrega un lote de lecturas desde texto
+     * @param valoresTxt Arreglo de valores en formato texto
+     * @param n Cantidad de valores en el arreglo
+     *
+     * Convierte los textos a número por bloques y delega en agregarLote(),
+     * de modo que el lote completo se despacha con pocas llamadas virtuales.
+     */
+    void agregarLoteDesdeTexto(const char* const* valoresTxt, int n) {
+        const int BLOQUE = 64;
+        double valores[BLOQUE];
+        int i = 0;
+        while (i < n) {
+            int k = 0;
+            while (k < BLOQUE && i < n) {
+                valores[k++] = std::atof(valoresTxt[i++]);
+            }
+            agregarLote(valores, k);
+        }
+    }
+
     /**
      * @brief Procesa las lecturas del sensor
      * 
@@ -74,4 +259,26 @@ public:
     virtual void imprimirInfo() const = 0;
 };
 
+inline void ListaPendientes::agregar(SensorBase* s) {
+    if (s->enPendientes) return;
+    s->enPendientes = true;
+    s->sigPendiente = nullptr;
+    if (!cabeza) {
+        cabeza = s;
+    } else {
+        cola->sigPendiente = s;
+    }
+    cola = s;
+}
+
+inline SensorBase* ListaPendientes::extraer() {
+    SensorBase* s = cabeza;
+    if (!s) return nullptr;
+    cabeza = s->sigPendiente;
+    if (!cabeza) cola = nullptr;
+    s->sigPendiente = nullptr;
+    s->enPendientes = false;
+    return s;
+}
+
 #endif
@@ -28,7 +28,9 @@ public:
      * @brief Constructor del sensor de presión
      * @param nom Identificador único del sensor
      */
-    SensorPresion(const char* nom) : SensorBase(nom) {}
+    SensorPresion(const char* nom) : SensorBase(nom) {
+        filtro.configurar(PoliticaFiltro::presion());
+    }
 
     /**
      * @brief Destructor virtual
@@ -41,14 +43,57 @@ public:
      * @brief Agrega una lectura de presión desde texto
      * @param valorTxt Valor de presión en formato texto
      * 
-     * Convierte el texto a entero y lo almacena en el historial.
+     * Convierte el texto a entero y lo almacena en el historial si
+     * el filtro de lecturas atípicas lo acepta.
      */
     void agregarLecturaDesdeTexto(const char* valorTxt) override {
         int v = atoi(valorTxt);
+        if (!filtro.aceptar(v)) {
+            std::cout << "[Filtro] Lectura atípica descartada en " << nombre << ": " << v << " hPa\n";
+            return;
+        }
         historial.insertarFinal(v);
+        marcarModificado();
+        evaluarReglas(v);
         std::cout << "[Log] Insertando lectura de presión en " << nombre << ": " << v << " hPa\n";
     }
 
+    /**
+     * @brief Agrega un lote de lecturas de presión
+     * @param valores Arreglo de valores ya convertidos
+     * @param n Cantidad de valores en el arreglo
+     *
+     * Convierte los valores a int, descarta los atípicos según el filtro
+     * del sensor y enlaza los aceptados al historial con una sola
+     * inserción por bloque.
+     */
+    void agregarLote(const double* valores, int n) override {
+        const int BLOQUE = 64;
+        int buffer[BLOQUE];
+        int aceptadas = 0;
+        int i = 0;
+        while (i < n) {
+            int k = 0;
+            while (k < BLOQUE && i < n) {
+                if (filtro.aceptar(valores[i])) {
+                    buffer[k] = static_cast<int>(valores[i]);
+                    evaluarReglas(buffer[k]);
+                    k++;
+                }
+                i++;
+            }
+            historial.insertarLote(buffer, k);
+            aceptadas += k;
+        }
+        if (aceptadas > 0) {
+            marcarModificado();
+        }
+        std::cout << "[Log] Insertando lote de " << aceptadas << " lecturas de presión en " << nombre << "\n";
+        if (aceptadas < n) {
+            std::cout << "[Filtro] " << (n - aceptadas) << " lectura(s) atípica(s) descartada(s) en " << nombre << "\n";
+        }
+    }
+
     /**
      * @brief Procesa las lecturas de presión
      * 
@@ -62,6 +107,8 @@ public:
             return;
         }
         int prom = historial.promedio();
+        ultimoPromedio = prom;
+        conResultado = true;
         std::cout << "   Presión promedio: " << prom << " hPa\n";
     }
 
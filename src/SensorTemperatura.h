@@ -18,7 +18,7 @@
  * 
  * Hereda de SensorBase e implementa funcionalidades específicas
  * para el manejo de datos de temperatura, incluyendo filtrado
- * de valores extremos y cálculo de promedios.
+ * de valores atípicos al ingreso y cálculo de promedios.
  */
 class SensorTemperatura : public SensorBase {
 private:
@@ -29,7 +29,9 @@ public:
      * @brief Constructor del sensor de temperatura
      * @param nom Identificador único del sensor
      */
-    SensorTemperatura(const char* nom) : SensorBase(nom) {}
+    SensorTemperatura(const char* nom) : SensorBase(nom) {
+        filtro.configurar(PoliticaFiltro::temperatura());
+    }
 
     /**
      * @brief Destructor virtual
@@ -42,19 +44,64 @@ public:
      * @brief Agrega una lectura de temperatura desde texto
      * @param valorTxt Valor de temperatura en formato texto
      * 
-     * Convierte el texto a float y lo almacena en el historial.
+     * Convierte el texto a float y lo almacena en el historial si
+     * el filtro de lecturas atípicas lo acepta.
      */
     void agregarLecturaDesdeTexto(const char* valorTxt) override {
         float v = static_cast<float>(atof(valorTxt));
+        if (!filtro.aceptar(v)) {
+            std::cout << "[Filtro] Lectura atípica descartada en " << nombre << ": " << v << "°C\n";
+            return;
+        }
         historial.insertarFinal(v);
+        marcarModificado();
+        evaluarReglas(v);
         std::cout << "[Log] Insertando lectura de temperatura en " << nombre << ": " << v << "°C\n";
     }
 
+    /**
+     * @brief Agrega un lote de lecturas de temperatura
+     * @param valores Arreglo de valores ya convertidos
+     * @param n Cantidad de valores en el arreglo
+     *
+     * Convierte los valores a float, descarta los atípicos según el filtro
+     * del sensor y enlaza los aceptados al historial con una sola
+     * inserción por bloque.
+     */
+    void agregarLote(const double* valores, int n) override {
+        const int BLOQUE = 64;
+        float buffer[BLOQUE];
+        int aceptadas = 0;
+        int i = 0;
+        while (i < n) {
+            int k = 0;
+            while (k < BLOQUE && i < n) {
+                float v = static_cast<float>(valores[i]);
+                if (filtro.aceptar(v)) {
+                    buffer[k] = v;
+                    evaluarReglas(buffer[k]);
+                    k++;
+                }
+                i++;
+            }
+            historial.insertarLote(buffer, k);
+            aceptadas += k;
+        }
+        if (aceptadas > 0) {
+            marcarModificado();
+        }
+        std::cout << "[Log] Insertando lote de " << aceptadas << " lecturas de temperatura en " << nombre << "\n";
+        if (aceptadas < n) {
+            std::cout << "[Filtro] " << (n - aceptadas) << " lectura(s) atípica(s) descartada(s) en " << nombre << "\n";
+        }
+    }
+
     /**
      * @brief Procesa las lecturas de temperatura
      * 
-     * Elimina la temperatura más baja (posible error de lectura)
-     * y calcula el promedio de las lecturas restantes.
+     * Calcula el promedio del historial. Las lecturas erróneas ya
+     * fueron descartadas al ingreso por el filtro, por lo que el
+     * historial no se modifica al procesar.
      */
     void procesarLectura() override {
         std::cout << "-> Procesando Sensor " << nombre << " (Temperatura)\n";
@@ -62,10 +109,10 @@ public:
             std::cout << "   No hay lecturas disponibles.\n";
             return;
         }
-        
-        historial.eliminarMenor(); // Filtrar posibles lecturas erróneas
         float prom = historial.promedio();
-        std::cout << "   Temperatura promedio (sin valor mínimo): " << prom << "°C\n";
+        ultimoPromedio = prom;
+        conResultado = true;
+        std::cout << "   Temperatura promedio (lecturas filtradas): " << prom << "°C\n";
     }
 
     /**
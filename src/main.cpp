@@ -2,11 +2,18 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <termios.h>
+#include <poll.h>
 #include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <time.h>
 
 #include "ListaGestion.h"
 #include "SensorTemperatura.h"
 #include "SensorPresion.h"
+#include "ColaAlertas.h"
+#include "ReglaAlerta.h"
+#include "ProtocoloBinario.h"
 
 using namespace std;
 
@@ -34,6 +41,8 @@ int configurarSerial(const char* puerto) {
 
     opciones.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG); // modo raw
     opciones.c_iflag &= ~(IXON | IXOFF | IXANY);
+    // 8 bits limpios: sin esto un 0x0D dentro de una trama binaria llega como 0x0A
+    opciones.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL);
     opciones.c_oflag &= ~OPOST;
 
     tcsetattr(serial, TCSANOW, &opciones);
@@ -41,58 +50,171 @@ int configurarSerial(const char* puerto) {
     return serial;
 }
 
-// Lee una línea del puerto serial hasta '\n'
-bool leerLinea(int fd, char* buffer, size_t maxLen) {
-    size_t idx = 0;
-    while (idx < maxLen - 1) {
-        char c;
-        int n = read(fd, &c, 1);
-        if (n > 0) {
+// Formato de la trama recibida
+enum TipoTrama {
+    TRAMA_TEXTO,   // línea "T;T-001;25.6" en el buffer de texto (aún sin validar)
+    TRAMA_BINARIA, // trama binaria válida ya decodificada
+    TRAMA_ERRONEA  // trama binaria con CRC inválido, o línea demasiado larga o
+                   // cortada por una trama binaria (descartada)
+};
+
+// Lee tramas del puerto y detecta su formato por el byte de sincronía.
+// Los bytes de una trama binaria rechazada se devuelven a un buffer y se vuelven
+// a examinar, así la resincronización no consume bytes de la trama siguiente.
+struct LectorTramas {
+    int fd;
+    uint8_t devueltos[TRAMA_BYTES]; // bytes ya leídos del puerto pendientes de examinar
+    int nDevueltos;
+    bool sincroniaPendiente;        // se leyó una sincronía que cortó una línea de texto
+
+    LectorTramas() : fd(-1), nDevueltos(0), sincroniaPendiente(false) {}
+
+    // Lee un byte (primero los devueltos), esperando si todavía no hay datos
+    uint8_t leerByte() {
+        uint8_t c;
+        if (nDevueltos > 0) {
+            c = devueltos[0];
+            nDevueltos--;
+            std::memmove(devueltos, devueltos + 1, nDevueltos);
+            return c;
+        }
+        while (read(fd, &c, 1) <= 0) {
+            usleep(10000); // 10ms
+        }
+        return c;
+    }
+
+    // Indica si hay bytes por leer sin bloquear
+    bool hayDatosPendientes() {
+        if (nDevueltos > 0 || sincroniaPendiente) return true;
+        struct pollfd pfd;
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        return poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN);
+    }
+
+    // Completa una trama binaria cuyo byte de sincronía ya se leyó; si el CRC
+    // no coincide devuelve los bytes siguientes, que pueden iniciar otra trama
+    bool leerBinaria(TramaBinaria& bin) {
+        uint8_t buf[TRAMA_BYTES];
+        buf[0] = TRAMA_SINCRONIA;
+        for (int i = 1; i < TRAMA_BYTES; i++) {
+            buf[i] = leerByte();
+        }
+        if (decodificarTrama(buf, bin)) {
+            return true;
+        }
+        // Se devuelven como mucho los bytes que se sacaron del buffer o del
+        // puerto en esta misma llamada, así que siempre caben
+        std::memmove(devueltos + TRAMA_BYTES - 1, devueltos, nDevueltos);
+        std::memcpy(devueltos, buf + 1, TRAMA_BYTES - 1);
+        nDevueltos += TRAMA_BYTES - 1;
+        return false;
+    }
+
+    // Lee la siguiente trama. El texto se lee byte a byte hasta '\n'; si aparece
+    // TRAMA_SINCRONIA (que nunca está en una línea ASCII) la línea a medias se
+    // reporta como errónea y en la siguiente llamada se decodifica la trama binaria.
+    // Una línea que no cabe en el buffer se consume completa y también es errónea.
+    TipoTrama leer(char* linea, size_t maxLen, TramaBinaria& bin) {
+        size_t idx = 0;
+        bool desbordada = false;
+        while (true) {
+            bool devuelto = nDevueltos > 0;
+            uint8_t c;
+            if (sincroniaPendiente) {
+                sincroniaPendiente = false;
+                devuelto = false;
+                c = TRAMA_SINCRONIA;
+            } else {
+                c = leerByte();
+            }
+
+            if (c == TRAMA_SINCRONIA) {
+                if (idx > 0 || desbordada) {
+                    sincroniaPendiente = true;
+                    linea[idx] = '\0';
+                    return TRAMA_ERRONEA;
+                }
+                if (leerBinaria(bin)) {
+                    return TRAMA_BINARIA;
+                }
+                // Una sincronía tomada de los restos de una trama ya reportada
+                // es solo un intento de resincronizar: no se cuenta otra vez
+                if (!devuelto) {
+                    return TRAMA_ERRONEA;
+                }
+                continue;
+            }
+            if (devuelto) {
+                continue; // resto de una trama binaria rechazada
+            }
             if (c == '\n') {
-                buffer[idx] = '\0';
-                return true;
-            } else if (c != '\r') {
-                buffer[idx++] = c;
+                break;
+            }
+            if (c == '\r') {
+                continue;
+            }
+            if (idx < maxLen - 1) {
+                linea[idx++] = static_cast<char>(c);
+            } else {
+                desbordada = true;
             }
-        } else {
-            // no hay datos, dormir un poco
-            usleep(10000); // 10ms
-            // si no quieres bloquear tanto, puedes salir con false
         }
+        linea[idx] = '\0';
+        return desbordada ? TRAMA_ERRONEA : TRAMA_TEXTO;
     }
-    buffer[maxLen-1] = '\0';
-    return true;
-}
+};
+
+// Separa y valida "T;T-001;25.6" (se admite un 4o campo con la marca de tiempo).
+// Devuelve false si la trama no tiene ese formato: tipo T o P, ID "<tipo>-<digitos>"
+// y un valor numérico completo; en ese caso id y valor quedan vacíos.
+bool parsearLinea(const char* linea, char* tipo, char* id, char* valor) {
+    *tipo = 'X';
+    id[0] = '\0';
+    valor[0] = '\0';
 
-// Separa "T;T-001;25.6"
-void parsearLinea(const char* linea, char* tipo, char* id, char* valor) {
     char copia[128];
     std::strncpy(copia, linea, sizeof(copia));
     copia[sizeof(copia)-1] = '\0';
 
-    char* token = std::strtok(copia, ";");
-    if (token) {
-        *tipo = token[0];
-    } else {
-        *tipo = 'X';
-        return;
+    // strtok se salta los campos vacíos (";;;"), por eso se separa a mano
+    char* campos[4];
+    int n = 0;
+    char* p = copia;
+    while (true) {
+        if (n == 4) return false; // demasiados campos
+        campos[n++] = p;
+        char* sep = std::strchr(p, ';');
+        if (!sep) break;
+        *sep = '\0';
+        p = sep + 1;
     }
+    if (n < 3) return false;
 
-    token = std::strtok(nullptr, ";");
-    if (token) {
-        std::strncpy(id, token, 50);
-        id[49] = '\0';
-    } else {
-        id[0] = '\0';
+    const char* t = campos[0];
+    if (std::strlen(t) != 1 || (t[0] != 'T' && t[0] != 'P')) return false;
+
+    const char* d = campos[1];
+    if (d[0] != t[0] || d[1] != '-' || d[2] == '\0' || std::strlen(d) >= 50) return false;
+    for (d += 2; *d; d++) {
+        if (*d < '0' || *d > '9') return false;
     }
 
-    token = std::strtok(nullptr, ";");
-    if (token) {
-        std::strncpy(valor, token, 50);
-        valor[49] = '\0';
-    } else {
-        valor[0] = '\0';
+    char* fin;
+    double v = std::strtod(campos[2], &fin);
+    if (fin == campos[2] || *fin != '\0' || !std::isfinite(v) || std::strlen(campos[2]) >= 50) return false;
+
+    if (n == 4) {
+        std::strtoll(campos[3], &fin, 10);
+        if (fin == campos[3] || *fin != '\0') return false;
     }
+
+    *tipo = t[0];
+    std::strcpy(id, campos[1]);
+    std::strcpy(valor, campos[2]);
+    return true;
 }
 // =====================================================
 
@@ -113,12 +235,158 @@ SensorBase* crearSensorPorTipo(char tipo, const char* id, ListaGestion& lista) {
     return s;
 }
 
-int main() {
+// Devuelve la marca de envío (4o campo, en microsegundos) que agrega
+// simulador_iot -m, o -1 si la línea no la trae
+long long extraerMarcaUs(const char* linea) {
+    const char* p = linea;
+    for (int campo = 0; campo < 3; campo++) {
+        p = std::strchr(p, ';');
+        if (!p) return -1;
+        p++;
+    }
+    return std::atoll(p);
+}
+
+// Microsegundos de CLOCK_MONOTONIC (mismo reloj que usa simulador_iot)
+long long ahoraUs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<long long>(ts.tv_sec) * 1000000LL + ts.tv_nsec / 1000;
+}
+
+// Lineas por segundo, tramas rechazadas y latencia en el modo continuo. La latencia va
+// desde la marca de envío hasta que la lectura entra al sensor (filtro y reglas incluidos)
+struct EstadisticasIngreso {
+    static const long long PERIODO_US = 5000000; // cada cuanto se reporta
+    long long inicioUs;
+    long long lineas;
+    long long rechazadas;
+    long long conMarca;
+    long long sumaLatenciaUs;
+    long long maxLatenciaUs;
+
+    EstadisticasIngreso() {
+        reiniciar(ahoraUs());
+    }
+
+    void reiniciar(long long t) {
+        inicioUs = t;
+        lineas = 0;
+        rechazadas = 0;
+        conMarca = 0;
+        sumaLatenciaUs = 0;
+        maxLatenciaUs = 0;
+    }
+
+    // Registra una trama aceptada y reporta al cumplirse el periodo
+    void registrar() {
+        lineas++;
+        reportar(ahoraUs());
+    }
+
+    // Registra la latencia de una lectura entregada a su sensor en el instante t
+    // (marca = -1 si la trama no la trae)
+    void registrarLatencia(long long marca, long long t) {
+        if (marca > 0 && marca <= t) {
+            long long lat = t - marca;
+            conMarca++;
+            sumaLatenciaUs += lat;
+            if (lat > maxLatenciaUs) maxLatenciaUs = lat;
+        }
+    }
+
+    // Registra una trama descartada por formato o CRC inválido
+    void rechazar() {
+        rechazadas++;
+        reportar(ahoraUs());
+    }
+
+    void reportar(long long t) {
+        if (t - inicioUs < PERIODO_US) return;
+        double seg = (t - inicioUs) / 1e6;
+        cout << "[Stats] " << static_cast<long long>(lineas / seg) << " lineas/s";
+        if (rechazadas > 0) {
+            cout << ", " << rechazadas << " tramas rechazadas";
+        }
+        if (conMarca > 0) {
+            cout << ", latencia envio-sensor prom " << sumaLatenciaUs / conMarca
+                 << " us, max " << maxLatenciaUs << " us";
+        }
+        cout << "\n";
+        reiniciar(t);
+    }
+};
+
+// En modo continuo se procesa cada LINEAS_POR_PROCESO lineas, y antes se despacha
+// el lote pendiente; por eso un lote nunca supera ese tamaño
+const int LINEAS_POR_PROCESO = 5;
+
+// Lecturas consecutivas de un mismo sensor, despachadas en una sola llamada
+struct LoteLecturas {
+    static const int MAX = LINEAS_POR_PROCESO;
+    SensorBase* sensor;
+    double valores[MAX];
+    long long marcas[MAX]; // marca de envío de cada lectura (-1 si no trae)
+    int n;
+
+    LoteLecturas() : sensor(nullptr), n(0) {}
+};
+
+// Entrega el lote a su sensor, registra la latencia de cada lectura y lo deja vacío
+void despacharLote(LoteLecturas& lote, EstadisticasIngreso& stats) {
+    if (lote.n == 0) return;
+    lote.sensor->agregarLote(lote.valores, lote.n);
+    long long t = ahoraUs();
+    for (int i = 0; i < lote.n; i++) {
+        stats.registrarLatencia(lote.marcas[i], t);
+    }
+    lote.n = 0;
+}
+
+// Agrega una lectura al lote; si cambia el sensor o se llena, despacha antes
+void acumularEnLote(LoteLecturas& lote, SensorBase* s, double valor, long long marca,
+                    EstadisticasIngreso& stats) {
+    if (lote.n > 0 && (lote.sensor != s || lote.n == LoteLecturas::MAX)) {
+        despacharLote(lote, stats);
+    }
+    lote.sensor = s;
+    lote.valores[lote.n] = valor;
+    lote.marcas[lote.n] = marca;
+    lote.n++;
+}
+
+// Busca el sensor de una línea de texto ya validada; si no existe, lo crea
+SensorBase* resolverSensor(char tipo, const char* id, ListaGestion& lista) {
+    SensorBase* s = lista.buscarPorNombre(id);
+    if (!s) {
+        cout << "Sensor " << id << " no existe, creando...\n";
+        s = crearSensorPorTipo(tipo, id, lista);
+    }
+    return s;
+}
+
+// Busca el sensor de una trama binaria por su ID numérico, sin armar el nombre;
+// solo si hay que crearlo se forma "T-001". Devuelve nullptr si el tipo no es válido
+SensorBase* resolverSensorBinario(const TramaBinaria& bin, ListaGestion& lista) {
+    SensorBase* s = lista.buscarPorId(bin.tipo, bin.id);
+    if (!s && (bin.tipo == 'T' || bin.tipo == 'P')) {
+        char id[50];
+        nombreDesdeTrama(bin, id, sizeof(id));
+        s = resolverSensor(bin.tipo, id, lista);
+    }
+    return s;
+}
+
+int main(int argc, char* argv[]) {
     cout << "--- Sistema IoT de Monitoreo Polimórfico ---\n";
 
     ListaGestion lista;
+    ColaAlertas colaAlertas;                     // sensores -> notificador, sin bloqueos
+    NotificadorAlertas notificador(colaAlertas); // hilo que imprime las alertas
     int fdSerial = -1;         // lo abriremos solo si el usuario quiere
-    const char* puerto = "/dev/ttyUSB0";
+    LectorTramas lector;       // conserva los bytes pendientes entre lecturas
+    // El puerto puede indicarse como argumento (ej. el pseudo-terminal de simulador_iot)
+    const char* puerto = (argc > 1) ? argv[1] : "/dev/ttyUSB0";
 
     bool salir = false;
     while (!salir) {
@@ -129,7 +397,8 @@ int main() {
         cout << "4. Listar sensores\n";
         cout << "5. Abrir/usar puerto serial y leer 1 linea del Arduino\n";
         cout << "6. Leer continuamente del Arduino (demo)\n";
-        cout << "7. Salir\n";
+        cout << "7. Agregar regla de alerta a un sensor\n";
+        cout << "8. Salir\n";
         cout << "Elige opcion: ";
         int op;
         cin >> op;
@@ -178,48 +447,72 @@ int main() {
                     cout << "No se pudo abrir el puerto.\n";
                     continue;
                 }
+                lector.fd = fdSerial;
                 cout << "Esperando a que Arduino reinicie...\n";
                 usleep(2000000);
             }
 
             char linea[128];
+            TramaBinaria bin;
             cout << "Esperando 1 linea del Arduino...\n";
-            if (leerLinea(fdSerial, linea, sizeof(linea))) {
+            TipoTrama trama = lector.leer(linea, sizeof(linea), bin);
+            if (trama == TRAMA_ERRONEA) {
+                cout << "[RX] Trama con CRC invalido o linea incompleta, descartada.\n";
+                continue;
+            }
+            if (trama == TRAMA_TEXTO) {
                 cout << "[RX] " << linea << "\n";
                 char tipo;
                 char id[50];
                 char valor[50];
-                parsearLinea(linea, &tipo, id, valor);
-
-                // si no existe el sensor, lo creamos
-                SensorBase* s = lista.buscarPorNombre(id);
-                if (!s) {
-                    cout << "Sensor " << id << " no existe, creando...\n";
-                    s = crearSensorPorTipo(tipo, id, lista);
+                if (!parsearLinea(linea, &tipo, id, valor)) {
+                    cout << "[RX] Trama con formato invalido, descartada.\n";
+                    continue;
                 }
+                // si no existe el sensor, lo creamos
+                SensorBase* s = resolverSensor(tipo, id, lista);
                 if (s) {
                     s->agregarLecturaDesdeTexto(valor);
                 }
             } else {
-                cout << "No se recibio linea.\n";
+                cout << "[RX bin] " << bin.tipo << " " << bin.id << " " << bin.valor << "\n";
+                SensorBase* s = resolverSensorBinario(bin, lista);
+                if (!s) {
+                    cout << "[RX] Trama binaria con tipo desconocido, descartada.\n";
+                    continue;
+                }
+                s->agregarLote(&bin.valor, 1);
             }
         }
         else if (op == 6) {
             // Modo continuo: se queda leyendo del Arduino y cada 5 lecturas procesa
+            // los sensores que recibieron datos nuevos
             if (fdSerial < 0) {
                 fdSerial = configurarSerial(puerto);
                 if (fdSerial < 0) {
                     cout << "No se pudo abrir el puerto.\n";
                     continue;
                 }
+                lector.fd = fdSerial;
                 cout << "Esperando a que Arduino reinicie...\n";
                 usleep(2000000);
             }
             cout << "Leyendo continuamente (Ctrl+C para matar el programa)...\n";
+            // Las lineas consecutivas del mismo sensor se agrupan en un lote,
+            // que se despacha al cambiar de sensor o cuando el puerto se vacia
+            LoteLecturas lote;
+            EstadisticasIngreso stats;
             int contador = 0;
             while (true) {
                 char linea[128];
-                if (leerLinea(fdSerial, linea, sizeof(linea))) {
+                TramaBinaria bin;
+                TipoTrama trama = lector.leer(linea, sizeof(linea), bin);
+                if (trama == TRAMA_ERRONEA) {
+                    cout << "[RX] Trama con CRC invalido o linea incompleta, descartada.\n";
+                    stats.rechazar();
+                    continue;
+                }
+                if (trama == TRAMA_TEXTO) {
                     if (std::strlen(linea) == 0)
                         continue;
                     cout << "[RX] " << linea << "\n";
@@ -227,25 +520,92 @@ int main() {
                     char tipo;
                     char id[50];
                     char valor[50];
-                    parsearLinea(linea, &tipo, id, valor);
-
-                    SensorBase* s = lista.buscarPorNombre(id);
-                    if (!s) {
-                        cout << "Sensor " << id << " no existe, creando...\n";
-                        s = crearSensorPorTipo(tipo, id, lista);
+                    if (!parsearLinea(linea, &tipo, id, valor)) {
+                        // No avanza el contador: solo cuentan las lecturas aceptadas
+                        cout << "[RX] Trama con formato invalido, descartada.\n";
+                        stats.rechazar();
+                        continue;
                     }
-                    if (s) {
-                        s->agregarLecturaDesdeTexto(valor);
+                    // Lo habitual es que la línea sea del mismo sensor que el lote en curso
+                    SensorBase* s = (lote.n > 0 && std::strcmp(lote.sensor->getNombre(), id) == 0)
+                                    ? lote.sensor : resolverSensor(tipo, id, lista);
+                    if (!s) continue;
+                    stats.registrar();
+                    acumularEnLote(lote, s, std::atof(valor), extraerMarcaUs(linea), stats);
+                } else {
+                    // La trama binaria ya trae el valor y el ID numéricos: no hay texto
+                    // que analizar ni nombres que comparar
+                    cout << "[RX bin] " << bin.tipo << " " << bin.id << " " << bin.valor << "\n";
+                    SensorBase* s = resolverSensorBinario(bin, lista);
+                    if (!s) {
+                        cout << "[RX] Trama binaria con tipo desconocido, descartada.\n";
+                        stats.rechazar();
+                        continue;
                     }
+                    stats.registrar();
+                    acumularEnLote(lote, s, bin.valor, -1, stats);
+                }
 
-                    contador++;
-                    if (contador % 5 == 0) {
-                        lista.procesarTodos();
-                    }
+                contador++;
+                if (contador % LINEAS_POR_PROCESO == 0 || !lector.hayDatosPendientes()) {
+                    despacharLote(lote, stats);
+                }
+                if (contador % LINEAS_POR_PROCESO == 0) {
+                    lista.procesarModificados();
                 }
             }
         }
         else if (op == 7) {
+            // Regla de alerta: umbral sobre cada lectura o sobre el promedio en una ventana
+            char id[50];
+            cout << "ID del sensor: ";
+            cin.getline(id, 50);
+            SensorBase* s = lista.buscarPorNombre(id);
+            if (!s) {
+                cout << "No existe ese sensor.\n";
+                continue;
+            }
+            char tipo = 'X';
+            char comp = 'X';
+            double umbral = 0;
+            int segundos = 0;
+            cout << "Tipo de regla (I=lectura instantanea, V=promedio en ventana): ";
+            cin >> tipo;
+            bool enVentana = (tipo == 'V' || tipo == 'v');
+            cout << "Comparacion (> o <): ";
+            cin >> comp;
+            cout << "Umbral: ";
+            cin >> umbral;
+            if (enVentana) {
+                cout << "Duracion de la ventana en segundos: ";
+                cin >> segundos;
+            }
+            bool entradaValida = static_cast<bool>(cin);
+            cin.clear(); // primero se limpia el error, si no ignore() no descarta nada
+            cin.ignore(1000, '\n');
+            if (!entradaValida) {
+                cout << "Regla no valida: se esperaba un numero.\n";
+                continue;
+            }
+            if (!enVentana && tipo != 'I' && tipo != 'i') {
+                cout << "Regla no valida: el tipo debe ser I o V.\n";
+                continue;
+            }
+            if (comp != '>' && comp != '<') {
+                cout << "Regla no valida: la comparacion debe ser > o <.\n";
+                continue;
+            }
+            if (enVentana && segundos <= 0) {
+                cout << "Regla no valida: la ventana debe durar al menos 1 segundo.\n";
+                continue;
+            }
+            long long ventanaMs = segundos * 1000LL;
+            ReglaAlerta regla(enVentana ? ReglaAlerta::PROMEDIO_VENTANA : ReglaAlerta::INSTANTANEA,
+                              comp == '>', umbral, ventanaMs);
+            s->agregarRegla(regla, &colaAlertas);
+            cout << "Regla '" << regla.getDescripcion() << "' agregada a " << id << ".\n";
+        }
+        else if (op == 8) {
             salir = true;
         }
         else {